@@ -0,0 +1,94 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "SpinLock.cpp"
+
+// Spin-then-park mutex. SpinLock never sleeps (burns a core while a long critical section
+// runs) and std::mutex goes to the kernel almost immediately (a futex round trip for a
+// sub-microsecond critical section). This spins for a while, then parks on a futex via
+// std::atomic::wait.
+//
+// How long to spin is self-calibrating, like glibc's PTHREAD_MUTEX_ADAPTIVE_NP: the spin
+// count it took to get the lock in the past is a proxy for how long the lock is usually held,
+// so short hold times keep the spin budget small-but-sufficient and long ones push it up
+// to the cap, after which we park instead of wasting the core.
+//
+// Lockable (lock/unlock/try_lock): works with std::lock_guard, std::unique_lock,
+// std::scoped_lock and std::condition_variable_any.
+class AdaptiveMutex {
+    // 0 = unlocked, 1 = locked, 2 = locked and someone may be parked (Drepper's futex mutex)
+    std::atomic<std::uint32_t> state{0};
+    std::atomic<std::int32_t> average_spins{0};  // moving average of spins needed to acquire
+
+    static constexpr std::int32_t kMaxSpins = 1000;
+
+    std::int32_t spin_limit() const {
+        std::int32_t limit = average_spins.load(std::memory_order_relaxed) * 2 + 10;
+        return limit < kMaxSpins ? limit : kMaxSpins;
+    }
+
+    void record_spins(std::int32_t spins) {
+        // Exponential moving average with weight 1/8 - racy updates are fine, it is only a hint
+        std::int32_t average = average_spins.load(std::memory_order_relaxed);
+        average_spins.store(average + (spins - average) / 8, std::memory_order_relaxed);
+    }
+
+    // Returns the number of spins taken before acquiring or parking
+    std::uint32_t lock_slow() {
+        const std::int32_t limit = spin_limit();
+        std::int32_t spins = 0;
+
+        // Phase 1: spin on a plain load (TTAS), attempt the CAS only when it looks free
+        for (; spins < limit; ++spins) {
+            cpu_relax();
+            std::uint32_t expected = 0;
+            if (state.load(std::memory_order_relaxed) == 0 &&
+                state.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                record_spins(spins);
+                return static_cast<std::uint32_t>(spins);
+            }
+        }
+        record_spins(spins);  // Spinning did not pay off - the average drifts towards the cap
+
+        // Phase 2: mark contended and park. We may own the lock in state 2 without any waiter,
+        // which only costs one spurious notify on unlock
+        std::uint32_t previous = state.exchange(2, std::memory_order_acquire);
+        while (previous != 0) {
+            state.wait(2, std::memory_order_relaxed);   // futex wait while state == 2
+            previous = state.exchange(2, std::memory_order_acquire);
+        }
+        return static_cast<std::uint32_t>(spins);
+    }
+
+public:
+    AdaptiveMutex() = default;
+    AdaptiveMutex(const AdaptiveMutex&) = delete;
+    AdaptiveMutex& operator=(const AdaptiveMutex&) = delete;
+
+    void lock() {
+        std::uint32_t spins;
+        lock(spins);
+    }
+    
+    // Same as lock(), also reporting how many spins the acquisition took (for InstrumentedLock)
+    void lock(std::uint32_t& spins) {
+        std::uint32_t expected = 0;
+        if (state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            spins = 0;
+            return;  // Uncontended fast path - one CAS, same as SpinLock
+        }
+        spins = lock_slow();
+    }
+
+    bool try_lock() {
+        std::uint32_t expected = 0;
+        return state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        // Only go to the kernel if somebody may be parked
+        if (state.exchange(0, std::memory_order_release) == 2) {
+            state.notify_one();
+        }
+    }
+};
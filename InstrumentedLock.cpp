@@ -0,0 +1,197 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+
+// Opt-in lock instrumentation. Wrap any Lockable (std::mutex, SpinLock, TTASSpinLock,
+// AdaptiveMutex, ...) as InstrumentedLock<L> and give it a name:
+//
+//     InstrumentedLock<std::mutex> queue_mutex{"ingest.queue"};
+//
+// Built without LOCK_INSTRUMENTATION it is just L with a constructor that ignores the name,
+// so it costs nothing, and LockRegistry::instance().dump() prints nothing. Built with
+// -DLOCK_INSTRUMENTATION every instance records acquisitions, contended acquisitions, spin
+// iterations and wait/hold time histograms, and registers itself with LockRegistry, whose
+// dump() prints every live lock. Spin iterations come from the wrapped lock: locks that offer
+// lock(std::uint32_t& spins) (TTASSpinLock, TicketLock, MCSLock, AdaptiveMutex) report them,
+// any other lock reports 0.
+
+#ifndef LOCK_INSTRUMENTATION
+
+template<typename Lock>
+class InstrumentedLock : public Lock {
+public:
+    explicit InstrumentedLock(const char* /*name*/ = "") {}
+};
+
+// Stub so dump() call sites need no #ifdef
+class LockRegistry {
+public:
+    static LockRegistry& instance() {
+        static LockRegistry registry;
+        return registry;
+    }
+
+    void dump(std::ostream& /*out*/) const {}
+};
+
+#else
+
+#include <bit>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// Power-of-two nanosecond buckets: bucket k counts durations in [2^(k-1), 2^k) ns
+class LatencyHistogram {
+public:
+    static constexpr std::size_t kBuckets = 40;   // up to ~9 minutes
+
+    void record(std::uint64_t nanos) {
+        std::size_t bucket = std::min<std::size_t>(std::bit_width(nanos), kBuckets - 1);
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void dump(std::ostream& out, const char* label) const {
+        out << "    " << label << ":";
+        for (std::size_t k = 0; k < kBuckets; ++k) {
+            std::uint64_t count = buckets[k].load(std::memory_order_relaxed);
+            if (count != 0) {
+                out << " <" << (std::uint64_t{1} << k) << "ns=" << count;
+            }
+        }
+        out << "\n";
+    }
+
+private:
+    std::atomic<std::uint64_t> buckets[kBuckets] = {};
+};
+
+struct LockStats {
+    std::string name;
+    std::atomic<std::uint64_t> acquisitions{0};
+    std::atomic<std::uint64_t> contended{0};        // try_lock failed, had to wait in lock()
+    std::atomic<std::uint64_t> spin_iterations{0};  // as reported by the wrapped lock's lock(spins)
+    LatencyHistogram wait_time;                     // contended acquisitions only
+    LatencyHistogram hold_time;
+
+    explicit LockStats(const char* lock_name) : name(lock_name) {}
+
+    void dump(std::ostream& out) const {
+        std::uint64_t total = acquisitions.load(std::memory_order_relaxed);
+        std::uint64_t slow = contended.load(std::memory_order_relaxed);
+        out << name << ": acquisitions=" << total
+            << " contended=" << slow
+            << " (" << (total ? 100.0 * slow / total : 0.0) << "%)"
+            << " spins=" << spin_iterations.load(std::memory_order_relaxed) << "\n";
+        wait_time.dump(out, "wait");
+        hold_time.dump(out, "hold");
+    }
+};
+
+// Every live InstrumentedLock, for dumping. Only construction, destruction and dump() lock it.
+class LockRegistry {
+public:
+    static LockRegistry& instance() {
+        static LockRegistry registry;
+        return registry;
+    }
+
+    void add(const LockStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        locks.push_back(stats);
+    }
+
+    void remove(const LockStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        locks.erase(std::remove(locks.begin(), locks.end(), stats), locks.end());
+    }
+
+    // Most contended first - the hot spots are at the top
+    void dump(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<const LockStats*> sorted = locks;
+        std::sort(sorted.begin(), sorted.end(), [](const LockStats* a, const LockStats* b) {
+            return a->contended.load(std::memory_order_relaxed) > b->contended.load(std::memory_order_relaxed);
+        });
+        for (const LockStats* stats : sorted) {
+            stats->dump(out);
+        }
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::vector<const LockStats*> locks;
+};
+
+template<typename Lock>
+class InstrumentedLock {
+    using Clock = std::chrono::steady_clock;
+
+    Lock lock_;
+    LockStats stats_;
+    Clock::time_point acquired_at_;   // written only by the owner
+
+    static std::uint64_t nanos_since(Clock::time_point start) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    void on_acquired() {
+        stats_.acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_at_ = Clock::now();
+    }
+
+public:
+    explicit InstrumentedLock(const char* name = "unnamed") : stats_(name) {
+        LockRegistry::instance().add(&stats_);
+    }
+
+    ~InstrumentedLock() {
+        LockRegistry::instance().remove(&stats_);
+    }
+
+    InstrumentedLock(const InstrumentedLock&) = delete;
+    InstrumentedLock& operator=(const InstrumentedLock&) = delete;
+
+    // One try_lock to tell contended from uncontended, then the wrapped lock's own lock() -
+    // no extra polling, so a blocking or FIFO lock behaves exactly as it does uninstrumented
+    void lock() {
+        if (lock_.try_lock()) {
+            on_acquired();
+            return;
+        }
+
+        stats_.contended.fetch_add(1, std::memory_order_relaxed);
+        Clock::time_point start = Clock::now();
+        if constexpr (requires(Lock& l, std::uint32_t& spins) { l.lock(spins); }) {
+            std::uint32_t spins = 0;
+            lock_.lock(spins);
+            stats_.spin_iterations.fetch_add(spins, std::memory_order_relaxed);
+        } else {
+            lock_.lock();
+        }
+        stats_.wait_time.record(nanos_since(start));
+        on_acquired();
+    }
+
+    bool try_lock() {
+        if (!lock_.try_lock()) {
+            return false;
+        }
+        on_acquired();
+        return true;
+    }
+
+    void unlock() {
+        stats_.hold_time.record(nanos_since(acquired_at_));
+        lock_.unlock();
+    }
+
+    const LockStats& stats() const { return stats_; }
+};
+
+#endif
@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "SpinLock.cpp"
+
+// Reader-writer spin lock for read-mostly data (config snapshots, price tables).
+// A single shared reader counter would turn every read_lock into an RMW on one hot cache
+// line, so read-heavy workloads would serialize on it. Here each reader bumps a counter in
+// its own cache-line slot (distributed reader indicator), so readers on different slots
+// never touch the same line. Writers pay instead: they have to scan every slot.
+//
+// Writer-preferring: once a writer announces itself, new readers back off, so a steady
+// stream of readers cannot starve writers.
+//
+// SharedLockable (lock/unlock/try_lock + lock_shared/unlock_shared/try_lock_shared):
+// works with std::unique_lock and std::shared_lock.
+class RWSpinLock {
+    static constexpr std::size_t kReaderSlots = 64;
+    
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint32_t> count{0};
+    };
+    
+    ReaderSlot readers[kReaderSlots];
+    alignas(64) std::atomic<bool> writer{false};
+    
+    // A thread keeps the same slot for life, so unlock_shared finds the slot lock_shared used
+    static std::atomic<std::uint32_t>& my_slot(ReaderSlot* slots) {
+        static std::atomic<std::size_t> next_slot{0};
+        thread_local std::size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed) % kReaderSlots;
+        return slots[slot].count;
+    }
+    
+    bool readers_drained() const {
+        for (const ReaderSlot& slot : readers) {
+            if (slot.count.load() != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+public:
+    void lock_shared() {
+        std::atomic<std::uint32_t>& slot = my_slot(readers);
+        while (true) {
+            // Announce, then check for a writer. The writer does the mirror image
+            // (set flag, then scan slots) - all seq_cst, so one of us always sees the other
+            slot.fetch_add(1);
+            if (!writer.load()) {
+                return;
+            }
+            slot.fetch_sub(1, std::memory_order_release);  // Writer active - step aside
+            while (writer.load(std::memory_order_relaxed)) {
+                cpu_relax();
+            }
+        }
+    }
+    
+    bool try_lock_shared() {
+        std::atomic<std::uint32_t>& slot = my_slot(readers);
+        slot.fetch_add(1);
+        if (!writer.load()) {
+            return true;
+        }
+        slot.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+    
+    void unlock_shared() {
+        my_slot(readers).fetch_sub(1, std::memory_order_release);
+    }
+    
+    void lock() {
+        // Writers exclude each other TTAS-style
+        while (writer.exchange(true)) {
+            while (writer.load(std::memory_order_relaxed)) {
+                cpu_relax();
+            }
+        }
+        // New readers now back off - wait for the ones already inside to leave
+        while (!readers_drained()) {
+            cpu_relax();
+        }
+    }
+    
+    bool try_lock() {
+        if (writer.load(std::memory_order_relaxed) || writer.exchange(true)) {
+            return false;
+        }
+        if (!readers_drained()) {
+            writer.store(false, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+    
+    void unlock() {
+        writer.store(false, std::memory_order_release);
+    }
+};
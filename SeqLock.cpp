@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "SpinLock.cpp"
+
+// Sequence lock for small trivially copyable data (a few cache lines at most).
+// Readers never write shared memory: they read the sequence number, copy the data, and
+// re-read the sequence number; if a writer was active (odd) or finished in between
+// (changed), they retry. Reads are therefore invisible to writers and to each other,
+// which makes this the cheapest option when reads vastly outnumber writes.
+// Writers are serialized by a TTASSpinLock and never wait for readers.
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock copies T byte-wise");
+    static_assert(std::is_default_constructible_v<T>, "load() builds the result in a T");
+    
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    
+    alignas(64) std::atomic<std::uint64_t> sequence{0};   // odd while a write is in progress
+    std::atomic<std::uint64_t> words[kWords];              // T stored as relaxed atomics - torn reads are detected, not UB
+    TTASSpinLock writer_lock;
+    
+public:
+    SeqLock() : SeqLock(T{}) {}
+    
+    explicit SeqLock(const T& initial) {
+        std::uint64_t buffer[kWords] = {};
+        std::memcpy(buffer, &initial, sizeof(T));
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+    }
+    
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+    
+    T load() const {
+        std::uint64_t buffer[kWords];
+        while (true) {
+            std::uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                cpu_relax();  // Writer in progress
+                continue;
+            }
+            for (std::size_t i = 0; i < kWords; ++i) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);  // Data loads cannot sink below the re-check
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        T result;
+        std::memcpy(&result, buffer, sizeof(T));
+        return result;
+    }
+    
+    void store(const T& value) {
+        std::uint64_t buffer[kWords] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        
+        writer_lock.lock();
+        std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);     // odd: readers will retry
+        std::atomic_thread_fence(std::memory_order_release);    // Data stores cannot rise above the odd mark
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(seq + 2, std::memory_order_release);     // even again: publish
+        writer_lock.unlock();
+    }
+};
+
+// Usage:
+// struct Quote { double bid; double ask; std::uint64_t ts; };
+// SeqLock<Quote> latest;
+//
+// latest.store(Quote{99.5, 100.5, now});   // writer
+// Quote q = latest.load();                 // any number of readers, never block the writer
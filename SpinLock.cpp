@@ -1,5 +1,23 @@
+#pragma once
 #include <iostream>
 #include <atomic>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+// Tell the CPU we are in a spin-wait loop. On x86 `pause` stops the core from
+// speculatively issuing loads (and the memory-order-violation flush when the
+// line changes) and yields pipeline resources to the sibling hyper-thread.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
 
 class SpinLock {
     std::atomic_flag flag = ATOMIC_FLAG_INIT;  // Initially false
@@ -18,8 +36,242 @@ public:
         // When we exit loop, we have successfully acquired the lock
     }
     
+    bool try_lock() {
+        // Single attempt - true if we got the lock
+        return !flag.test_and_set(std::memory_order_acquire);
+    }
+    
     void unlock() {
         // Set flag back to false, releasing the lock
         flag.clear(std::memory_order_release);
     }
 };
+
+// Test-and-test-and-set lock with exponential backoff.
+// SpinLock issues an RMW on every iteration, so each waiting core keeps pulling the
+// cache line in exclusive state and the owner's unlock has to fight for it. Here
+// waiters spin on a plain load (the line stays shared in every waiter's cache) and
+// only attempt the RMW once the lock looks free. Backoff spreads those attempts out
+// so a release does not trigger a thundering herd of test_and_set.
+class TTASSpinLock {
+    std::atomic<bool> locked{false};
+    
+    static constexpr std::uint32_t kMaxBackoff = 1024;  // pauses; caps the wait at roughly a few microseconds
+    
+public:
+    void lock() {
+        std::uint32_t spins;
+        lock(spins);
+    }
+    
+    // Same as lock(), also reporting how many pauses the acquisition took (for InstrumentedLock)
+    void lock(std::uint32_t& spins) {
+        std::uint32_t backoff = 1;
+        spins = 0;
+        
+        while (true) {
+            // Test-and-set only when the lock was observed free
+            if (!locked.exchange(true, std::memory_order_acquire)) {
+                return;
+            }
+            
+            // Lost the race: back off before touching the line again, doubling each time
+            for (std::uint32_t i = 0; i < backoff; ++i) {
+                cpu_relax();
+            }
+            spins += backoff;
+            if (backoff < kMaxBackoff) {
+                backoff <<= 1;
+            }
+            
+            // Test: read-only spin, no cache line ping-pong while the owner holds it
+            while (locked.load(std::memory_order_relaxed)) {
+                cpu_relax();
+                ++spins;
+            }
+        }
+    }
+    
+    bool try_lock() {
+        // Cheap load first - a failing try_lock should not steal the line from the owner
+        return !locked.load(std::memory_order_relaxed) &&
+               !locked.exchange(true, std::memory_order_acquire);
+    }
+    
+    void unlock() {
+        locked.store(false, std::memory_order_release);
+    }
+};
+
+// Ticket lock: FIFO-fair. Each waiter takes a ticket and waits for its number to be served,
+// so nobody can be overtaken (TAS/TTAS let a lucky core win over and over while others starve).
+// All waiters still spin on now_serving, so it trades some scalability for fairness.
+// With more waiters than cores the next ticket holder may be descheduled while everyone
+// behind it spins, so once a waiter has spent kSpinBudget pauses it yields its core instead.
+class TicketLock {
+    alignas(64) std::atomic<std::uint32_t> next_ticket{0};
+    alignas(64) std::atomic<std::uint32_t> now_serving{0};  // Own line - taking a ticket does not disturb spinners
+
+    static constexpr std::uint32_t kSpinBudget = 512;   // pauses (a few microseconds) before yielding
+    
+public:
+    void lock() {
+        std::uint32_t spins;
+        lock(spins);
+    }
+    
+    // Same as lock(), also reporting how many pauses (and yields) the acquisition took
+    void lock(std::uint32_t& spent) {
+        const std::uint32_t my_ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+        
+        spent = 0;
+        while (true) {
+            std::uint32_t serving = now_serving.load(std::memory_order_acquire);
+            if (serving == my_ticket) {
+                return;
+            }
+            if (spent >= kSpinBudget) {
+                std::this_thread::yield();   // Let the holder (or the next in line) run
+                ++spent;
+                continue;
+            }
+            // Proportional backoff: the further back in line, the longer we can wait before looking again
+            std::uint32_t ahead = my_ticket - serving;
+            for (std::uint32_t i = 0; i < ahead * 32; ++i) {
+                cpu_relax();
+            }
+            spent += ahead * 32;
+        }
+    }
+    
+    bool try_lock() {
+        // Free exactly when no ticket is outstanding: take the next ticket only if it is being served now
+        std::uint32_t serving = now_serving.load(std::memory_order_acquire);
+        std::uint32_t expected = serving;
+        return next_ticket.compare_exchange_strong(expected, serving + 1,
+                                                   std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    
+    void unlock() {
+        // Only the owner writes now_serving, so a plain load + store is enough
+        now_serving.store(now_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+// MCS queue lock: FIFO-fair and scalable. Waiters form a linked queue and each one spins on
+// the `locked` flag in its OWN node, so a release touches exactly one other core's cache line
+// instead of invalidating every waiter. Nodes come from a per-thread cache so the lock keeps
+// the plain lock()/unlock()/try_lock() interface (usable with std::lock_guard).
+// Handoff is FIFO, so a descheduled successor stalls everyone behind it: as in TicketLock,
+// a waiter that has spent kSpinBudget pauses yields its core on every further poll.
+class MCSLock {
+    struct alignas(64) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+    
+    // Per-thread free list of nodes. A thread holding k MCS locks at once uses k nodes.
+    struct NodeCache {
+        std::vector<Node*> free_nodes;
+        ~NodeCache() {
+            for (Node* node : free_nodes) {
+                delete node;
+            }
+        }
+    };
+    
+    static Node* acquire_node() {
+        NodeCache& cache = node_cache();
+        if (cache.free_nodes.empty()) {
+            return new Node;
+        }
+        Node* node = cache.free_nodes.back();
+        cache.free_nodes.pop_back();
+        return node;
+    }
+    
+    static void release_node(Node* node) {
+        node_cache().free_nodes.push_back(node);
+    }
+    
+    static NodeCache& node_cache() {
+        thread_local NodeCache cache;
+        return cache;
+    }
+    
+    std::atomic<Node*> tail{nullptr};
+    Node* owner_node = nullptr;  // Written only by the thread holding the lock
+    
+    static constexpr std::uint32_t kSpinBudget = 512;   // pauses (a few microseconds) before yielding
+    
+    // spent counts every poll, pauses and yields alike
+    static void spin_or_yield(std::uint32_t& spent) {
+        if (spent < kSpinBudget) {
+            cpu_relax();
+        } else {
+            std::this_thread::yield();   // Let the holder (or our predecessor / successor) run
+        }
+        ++spent;
+    }
+    
+public:
+    void lock() {
+        std::uint32_t spins;
+        lock(spins);
+    }
+    
+    // Same as lock(), also reporting how many polls the wait for our predecessor took
+    void lock(std::uint32_t& spent) {
+        spent = 0;
+        Node* me = acquire_node();
+        me->next.store(nullptr, std::memory_order_relaxed);
+        me->locked.store(true, std::memory_order_relaxed);
+        
+        // Join the queue. acq_rel: publish our node's init and see the predecessor's
+        Node* predecessor = tail.exchange(me, std::memory_order_acq_rel);
+        if (predecessor != nullptr) {
+            predecessor->next.store(me, std::memory_order_release);
+            
+            // Local spinning - only our predecessor ever writes this line
+            while (me->locked.load(std::memory_order_acquire)) {
+                spin_or_yield(spent);
+            }
+        }
+        owner_node = me;
+    }
+    
+    bool try_lock() {
+        Node* me = acquire_node();
+        me->next.store(nullptr, std::memory_order_relaxed);
+        Node* expected = nullptr;
+        if (tail.compare_exchange_strong(expected, me, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            owner_node = me;
+            return true;
+        }
+        release_node(me);
+        return false;
+    }
+    
+    void unlock() {
+        Node* me = owner_node;
+        Node* successor = me->next.load(std::memory_order_acquire);
+        
+        if (successor == nullptr) {
+            // No visible successor - try to mark the lock free
+            Node* expected = me;
+            if (tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                release_node(me);
+                return;
+            }
+            // Someone swapped tail but has not linked to us yet - wait for the link
+            std::uint32_t spent = 0;
+            while ((successor = me->next.load(std::memory_order_acquire)) == nullptr) {
+                spin_or_yield(spent);
+            }
+        }
+        
+        // Hand over directly to the next waiter; nobody references our node after this
+        successor->locked.store(false, std::memory_order_release);
+        release_node(me);
+    }
+};
@@ -1,6 +1,11 @@
 #include <iostream>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <optional>
+#include <utility>
 
 template <typename T>
 class CustomQueue
@@ -8,21 +13,54 @@ class CustomQueue
 private:
     struct Element
     {
-        T data;           // Could use std::shared_ptr<T> for exception safety
-        Element* next;    // Could use std::unique_ptr<Element> for automatic cleanup
+        std::optional<T> data;  // Empty in the dummy node - T need not be default-constructible
+        Element* next = nullptr;  // Could use std::unique_ptr<Element> for automatic cleanup
     };
     
     Element* Head;  // Raw pointer - consider unique_ptr for RAII
-    Element* Tail;  // Raw pointer - fine since owned by chain from Head
+    std::atomic<Element*> Tail;  // Atomic so consumers can read it without TailMutex
     
     std::mutex HeadMutex;  // Separate mutex for head - enables concurrent push/pop
-    std::mutex TailMutex;  // Separate mutex for tail - key to fine-grained locking
-    std::condition_variable cv;  // For blocking wait when queue empty
+    std::mutex TailMutex;  // Separate mutex for tail - now only serialises producers
+    std::condition_variable cv;  // For blocking wait when queue empty (used with HeadMutex)
+    std::atomic<size_t> Waiters{0};  // Consumers parked in cv.wait - push skips notify when 0
+    std::atomic<bool> Closed{false};  // Set once by close() - written under TailMutex
     
-    Element* get_tail()  // Helper to minimize TailMutex lock scope
+    Element* get_tail()  // Lock-free read - consumers never touch TailMutex
     {
-        std::lock_guard<std::mutex> tail_lock(TailMutex);  // Lock only for read
-        return Tail;  // Brief lock - better than holding throughout entire pop()
+        return Tail.load(std::memory_order_acquire);  // Pairs with the store in emplace(): node data is visible
+    }
+
+    T take_head()  // Called with HeadMutex held and queue non-empty
+    {
+        T datareturned = std::move(*Head->data);  // Move out - no deep copy
+        // Exception safety: if T's move throws, Head hasn't been advanced yet - element stays queued
+        
+        Element* oldelement = Head;  // Save old head for deletion
+        Head = Head->next;  // Move Head forward - just pointer reassignment
+        
+        delete oldelement;  // Free old node (its moved-from value is destroyed here)
+        
+        return datareturned;
+    }
+
+    // Called with HeadMutex held. Blocks (via wait) until data arrives or the queue is closed.
+    // Returns true if there is an element to take, false if closed and drained (or wait timed out).
+    template <typename WaitFn>
+    bool wait_for_data(std::unique_lock<std::mutex>& head_lock, WaitFn wait)
+    {
+        auto ready = [this]{ 
+            return Head != Tail.load() || Closed.load();  // seq_cst, pairs with push/close
+        };
+        if (!ready())  // Only register as a waiter when we actually have to block
+        {
+            Waiters.fetch_add(1);
+            wait(head_lock, ready);
+            Waiters.fetch_sub(1);
+        }
+        // Re-read Tail: close() happens after every successful push, so seeing Closed
+        // guarantees this load sees the final Tail - nothing gets stranded
+        return Head != get_tail();
     }
 
 public:
@@ -30,7 +68,7 @@ public:
     {
         Element* dummy = new Element();  // Dummy node ensures Head != Tail always
         Head = dummy;  // Both point to dummy initially
-        Tail = dummy;  // This separation prevents race conditions
+        Tail.store(dummy, std::memory_order_relaxed);  // This separation prevents race conditions
         // Why dummy? So push (touches Tail) and pop (touches Head) never conflict
     }
     
@@ -49,23 +87,45 @@ public:
     
     void push(T data)
     {
-        // Optimization: Allocate new dummy OUTSIDE lock - reduces critical section
+        emplace(std::move(data));  // Moved, never copied
+    }
+    
+    template <typename... Args>
+    void emplace(Args&&... args)  // Construct T in place - no temporary, no copy
+    {
+        // Optimization: Build the value and the new dummy OUTSIDE lock - reduces critical section
+        // If T's constructor throws here, the queue hasn't been touched (strong guarantee)
+        std::optional<T> value(std::in_place, std::forward<Args>(args)...);
         Element* newdummy = new Element();
-        newdummy->next = nullptr;
         
         {
             std::lock_guard<std::mutex> tail_lock(TailMutex);  // Lock only tail region
             // Only TailMutex locked - Head operations can proceed concurrently!
             
-            Tail->data = data;        // Put data in old dummy (converts to real node)
-            Tail->next = newdummy;    // Link new dummy after it
-            Tail = newdummy;          // Tail always points to dummy
+            if (Closed.load(std::memory_order_relaxed))  // close() also holds TailMutex
+            {
+                delete newdummy;
+                throw std::runtime_error("CustomQueue: push() on closed queue");
+            }
+            
+            Element* olddummy = Tail.load(std::memory_order_relaxed);  // Only producers write Tail
+            olddummy->data = std::move(value);  // Move data into old dummy (converts to real node)
+            olddummy->next = newdummy;          // Link new dummy after it
+            Tail.store(newdummy);               // Publish - seq_cst, see Waiters check below
             
             // Why this pattern? Push never touches Head, so no contention with pop()
         }  // Unlock BEFORE notify - optimization for waiting threads
         
-        cv.notify_one();  // Wake one waiting pop() thread if any
-        // Notify outside lock = waiting thread can immediately grab TailMutex in get_tail()
+        // Tail.store and this load are both seq_cst, pop() does the mirror image (Waiters++ then
+        // reads Tail), so either we see the waiter or the waiter sees our node
+        if (Waiters.load() == 0)
+        {
+            return;  // Fast path: no consumer parked -> no notify, no syscall
+        }
+        
+        // Taking HeadMutex orders us after a consumer that is between its check and cv.wait()
+        { std::lock_guard<std::mutex> head_lock(HeadMutex); }
+        cv.notify_one();  // Wake one waiting pop() thread
     }
     
     T pop()  // Blocking pop - waits if empty
@@ -73,26 +133,52 @@ public:
         std::unique_lock<std::mutex> head_lock(HeadMutex);  // unique_lock for cv.wait()
         // Only HeadMutex locked - push operations can proceed concurrently!
         
-        cv.wait(head_lock, [this]{ 
-            return Head != get_tail();  // Predicate: queue not empty
-            // get_tail() briefly locks TailMutex just to read Tail pointer
-            // This is why we unlock before notify in push() - reduces contention here
-        });
+        if (!wait_for_data(head_lock, [this](std::unique_lock<std::mutex>& lock, auto ready){ cv.wait(lock, ready); }))
+        {
+            throw std::runtime_error("CustomQueue: pop() on closed and drained queue");
+        }
         
         // At this point: Head != Tail guaranteed, queue has data
         
-        T datareturned = Head->data;  // Copy data out
-        // Optimization: Could return std::move(Head->data) for move-only types
-        // Exception risk: If T's copy throws, we've already removed from queue
-        // solution: use shared_ptr<T> to avoid copy
-        
-        Element* oldelement = Head;  // Save old head for deletion
-        Head = Head->next;  // Move Head forward - just pointer reassignment
+        return take_head();
+    }
+    
+    template <typename Rep, typename Period>
+    std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout)  // Blocking pop with timeout
+    {
+        return pop_until(std::chrono::steady_clock::now() + timeout);
+    }
+    
+    template <typename Clock, typename Duration>
+    std::optional<T> pop_until(const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        std::unique_lock<std::mutex> head_lock(HeadMutex);
         
-        delete oldelement;  // Free old node
-        // Optimization: Use unique_ptr to avoid manual delete
+        if (!wait_for_data(head_lock, [this, &deadline](std::unique_lock<std::mutex>& lock, auto ready){
+                cv.wait_until(lock, deadline, ready);
+            }))
+        {
+            return std::nullopt;  // Timed out, or closed and drained
+        }
         
-        return datareturned;
+        return take_head();
+    }
+    
+    // Shutdown: wakes every blocked consumer. Remaining elements can still be popped;
+    // once drained, pop_for/pop_until return empty and pop() throws. Further pushes throw.
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> tail_lock(TailMutex);  // Orders close after any in-flight push
+            Closed.store(true);
+        }
+        { std::lock_guard<std::mutex> head_lock(HeadMutex); }  // Same lost-wakeup guard as push()
+        cv.notify_all();
+    }
+    
+    bool is_closed() const
+    {
+        return Closed.load();
     }
     
     bool try_pop(T& value)  // Non-blocking pop - returns immediately
@@ -104,20 +190,26 @@ public:
             return false;  // Queue empty, return immediately (non-blocking)
         }
         
-        value = Head->data;  // Copy to reference parameter
-        // Optimization: Could use std::move for move-only types
+        value = take_head();  // Moved out - no deep copy
+        return true;  // Success
+    }
+    
+    std::optional<T> try_pop()  // Non-blocking pop for types without a cheap default constructor
+    {
+        std::lock_guard<std::mutex> head_lock(HeadMutex);
         
-        Element* oldelement = Head;
-        Head = Head->next;  // Advance Head
+        if(Head == get_tail())
+        {
+            return std::nullopt;  // Queue empty
+        }
         
-        delete oldelement;
-        return true;  // Success
+        return take_head();
     }
     
     bool empty()
     {
         std::lock_guard<std::mutex> head_lock(HeadMutex);  // Lock to safely read Head
         return Head == get_tail();  // Empty when both point to dummy
-        // get_tail() briefly locks TailMutex - very short lock duration
+        // get_tail() is a plain atomic load - producers are never slowed down by this
     }
 };
@@ -2,6 +2,9 @@
 #include <iostream>
 #include <mutex>
 #include <condition_variable>
+#include <optional>
+#include <chrono>
+#include <stdexcept>
 
 template <typename T>
 class  CustomQueue
@@ -17,6 +20,23 @@ class  CustomQueue
         Element* Tail;
         std::mutex m;
         std::condition_variable cv; 
+        bool closed = false;   // set by close(), guarded by m
+        
+        // Called with m held and Head != nullptr
+        T take_head()
+        {
+            T datareturned = std::move(Head->data);
+            Element* oldelement = Head;
+            Head= Head->next;  
+            
+            if(Head ==nullptr)
+            {
+                Tail= nullptr;
+            }
+            
+            delete oldelement;
+            return datareturned;
+        }
     
     public:
         CustomQueue() : Head(nullptr), Tail(nullptr) {}
@@ -33,6 +53,10 @@ class  CustomQueue
         void push(T data)
         {
             std::lock_guard<std::mutex> lock(m);
+            if(closed)
+            {
+                throw std::runtime_error("CustomQueue: push() on closed queue");
+            }
             Element* newElement = new Element{data,nullptr};
             if(Head==nullptr)
             {   
@@ -51,19 +75,47 @@ class  CustomQueue
         T pop()
         {
             std::unique_lock<std::mutex> lock(m);
-              cv.wait(lock, [this]{ return Head != nullptr; });
-               T datareturned = Head->data;
-               Element* oldelement = Head;
-               Head= Head->next;  
-               
-               if(Head ==nullptr)
-               {
-                   Tail= nullptr;
-               }
-            
-            delete oldelement;
-            return datareturned;
+              cv.wait(lock, [this]{ return Head != nullptr || closed; });
+              if(Head == nullptr)
+              {
+                  throw std::runtime_error("CustomQueue: pop() on closed and drained queue");
+              }
+              return take_head();
+        }
+        
+        template <typename Rep, typename Period>
+        std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout)
+        {
+            return pop_until(std::chrono::steady_clock::now() + timeout);
+        }
+        
+        // Returns empty on timeout, or once the queue is closed and drained
+        template <typename Clock, typename Duration>
+        std::optional<T> pop_until(const std::chrono::time_point<Clock, Duration>& deadline)
+        {
+            std::unique_lock<std::mutex> lock(m);
+            if(!cv.wait_until(lock, deadline, [this]{ return Head != nullptr || closed; }) || Head == nullptr)
+            {
+                return std::nullopt;
+            }
+            return take_head();
+        }
+        
+        // Wakes all blocked consumers; they drain what is left, then pops return empty / throw
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                closed = true;
+            }
+            cv.notify_all();
         }
         
+        bool is_closed()
+        {
+            std::lock_guard<std::mutex> lock(m);
+            return closed;
+        }
+
     
 };
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+// Same interface as ThreadSafeStack, but backed by a contiguous std::vector instead of
+// std::stack<T> (which is a std::deque underneath). Once reserve(n) has been called, pushes
+// up to n elements never allocate.
+template<typename T>
+class ThreadSafeVectorStack {
+private:
+    std::vector<T> data;
+    std::size_t reserved = 0;  // capacity floor requested via reserve(); shrink_to_fit() never goes below it
+    mutable std::mutex m;      //  kept mutable,  allows locking in const functions
+
+public:
+    ThreadSafeVectorStack() {}
+    explicit ThreadSafeVectorStack(std::size_t initial_capacity) {   // Pre-sized stack - no allocation until initial_capacity is exceeded
+        reserve(initial_capacity);
+    }
+    ThreadSafeVectorStack(const ThreadSafeVectorStack& other) {       // Copy constructor - locks the source stack during copy.
+        std::lock_guard<std::mutex> lock(other.m);
+        data.reserve(other.data.capacity());
+        data = other.data;
+        reserved = other.reserved;
+    }
+
+
+    ThreadSafeVectorStack& operator=(const ThreadSafeVectorStack&) = delete;  // Assignment operator deleted - prevents mutex assignment issues
+
+    void push(T value) {
+        std::lock_guard<std::mutex> lock(m);
+        data.push_back(std::move(value));   // Amortised O(1); no allocation while size() < capacity()
+    }
+
+    T pop() {
+        std::lock_guard<std::mutex> lock(m);
+        if(data.empty()) {
+            throw std::runtime_error("ThreadSafeVectorStack: pop() called on empty stack");
+        }
+        T val = std::move(data.back());
+        data.pop_back();                    // Capacity is kept - the next push reuses the slot
+        return val;
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(m);
+        if(data.empty()) {
+            return false;
+        }
+        value = std::move(data.back());
+        data.pop_back();
+        return true;
+    }
+
+    // Grow capacity to at least n and remember n as the floor for shrink_to_fit()
+    void reserve(std::size_t n) {
+        std::lock_guard<std::mutex> lock(m);
+        data.reserve(n);
+        reserved = n;
+    }
+
+    // Release memory above max(size(), reserved floor) - a pre-sized stack keeps its reservation
+    void shrink_to_fit() {
+        std::lock_guard<std::mutex> lock(m);
+        std::size_t target = data.size() > reserved ? data.size() : reserved;
+        if (data.capacity() <= target) {
+            return;
+        }
+        std::vector<T> shrunk;
+        shrunk.reserve(target);
+        for (T& item : data) {
+            shrunk.push_back(std::move(item));
+        }
+        data.swap(shrunk);
+    }
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(m);
+        return data.empty();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m);
+        return data.size();
+    }
+
+    size_t capacity() const {
+        std::lock_guard<std::mutex> lock(m);
+        return data.capacity();
+    }
+};
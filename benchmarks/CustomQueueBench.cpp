@@ -0,0 +1,174 @@
+//Two-lock CustomQueue (ThreadSafeQueue2.cpp) against its previous version, where every
+//get_tail() took TailMutex and every push notified the condition variable.
+//Two workloads: consumers polling try_pop in a tight loop, and consumers blocked in pop().
+//Reports items/s and the mean cost of a push as seen by the producers.
+//Build: g++ -std=c++20 -O2 -pthread CustomQueueBench.cpp -o custom_queue_bench
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../ThreadSafeQueue2.cpp"
+
+// CustomQueue as it was before the atomic Tail - the operations the benchmark uses
+template <typename T>
+class LockedTailQueue
+{
+private:
+    struct Element
+    {
+        std::optional<T> data;
+        Element* next = nullptr;
+    };
+
+    Element* Head;
+    Element* Tail;
+
+    std::mutex HeadMutex;
+    std::mutex TailMutex;
+    std::condition_variable cv;
+
+    Element* get_tail()
+    {
+        std::lock_guard<std::mutex> tail_lock(TailMutex);
+        return Tail;
+    }
+
+    T take_head()
+    {
+        T datareturned = std::move(*Head->data);
+        Element* oldelement = Head;
+        Head = Head->next;
+        delete oldelement;
+        return datareturned;
+    }
+
+public:
+    LockedTailQueue() : Head(new Element()), Tail(Head) {}
+
+    ~LockedTailQueue()
+    {
+        while (Head != nullptr)
+        {
+            Element* temp = Head;
+            Head = Head->next;
+            delete temp;
+        }
+    }
+
+    void push(T data)
+    {
+        std::optional<T> value(std::in_place, std::move(data));
+        Element* newdummy = new Element();
+        {
+            std::lock_guard<std::mutex> tail_lock(TailMutex);
+            Tail->data = std::move(value);
+            Tail->next = newdummy;
+            Tail = newdummy;
+        }
+        cv.notify_one();
+    }
+
+    T pop()
+    {
+        std::unique_lock<std::mutex> head_lock(HeadMutex);
+        cv.wait(head_lock, [this]{ return Head != get_tail(); });
+        return take_head();
+    }
+
+    std::optional<T> try_pop()
+    {
+        std::lock_guard<std::mutex> head_lock(HeadMutex);
+        if (Head == get_tail())
+        {
+            return std::nullopt;
+        }
+        return take_head();
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kProducers = 2;
+static constexpr int kConsumers = 2;
+static constexpr int kItemsPerProducer = 100000;
+
+struct Result
+{
+    double items_per_sec;
+    double push_ns;   // mean wall time a producer spent per push
+};
+
+template <typename Queue, typename Consume>
+static Result run(Consume consume)
+{
+    Queue queue;
+    std::atomic<long long> push_ns{0};
+    std::atomic<int> remaining{kProducers * kItemsPerProducer};
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        threads.emplace_back([&] {
+            auto begin = Clock::now();
+            for (int i = 0; i < kItemsPerProducer; ++i)
+            {
+                queue.push(i);
+            }
+            push_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c)
+    {
+        threads.emplace_back([&] { consume(queue, remaining); });
+    }
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return {kProducers * kItemsPerProducer / seconds,
+            static_cast<double>(push_ns.load()) / (kProducers * kItemsPerProducer)};
+}
+
+// Consumers spin on try_pop until every item has been taken
+template <typename Queue>
+static void poll_consumer(Queue& queue, std::atomic<int>& remaining)
+{
+    while (remaining.load(std::memory_order_relaxed) > 0)
+    {
+        if (queue.try_pop())
+        {
+            remaining.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Consumers block in pop(); each takes a fixed share so none is left waiting at the end
+template <typename Queue>
+static void blocking_consumer(Queue& queue, std::atomic<int>&)
+{
+    for (int i = 0; i < kProducers * kItemsPerProducer / kConsumers; ++i)
+    {
+        queue.pop();
+    }
+}
+
+static void report(const char* name, Result r)
+{
+    std::printf("%-34s %12.0f items/s   push %7.1f ns\n", name, r.items_per_sec, r.push_ns);
+}
+
+int main()
+{
+    report("CustomQueue, polling try_pop", run<CustomQueue<int>>(poll_consumer<CustomQueue<int>>));
+    report("locked tail, polling try_pop", run<LockedTailQueue<int>>(poll_consumer<LockedTailQueue<int>>));
+    report("CustomQueue, blocking pop", run<CustomQueue<int>>(blocking_consumer<CustomQueue<int>>));
+    report("locked tail, blocking pop", run<LockedTailQueue<int>>(blocking_consumer<LockedTailQueue<int>>));
+    return 0;
+}
@@ -0,0 +1,63 @@
+//Contention benchmark: FlatCombining against the mutex-based ThreadSafeQueue and ThreadSafeStack.
+//Every thread alternates push and pop on one shared container, so the container never runs dry;
+//the total number of operations is fixed, so the numbers show how throughput changes from 1 to 32 threads.
+//Build: g++ -std=c++20 -O2 -pthread FlatCombiningContention.cpp -o flat_combining_contention
+#include <chrono>
+#include <cstdio>
+#include <stack>
+#include <thread>
+#include <vector>
+#include "../FlatCombining"
+#include "../ThreadSafeQueue"
+#include "../ThreadSafeStack.cpp"
+
+using Clock = std::chrono::steady_clock;
+
+using CombiningQueue = FlatCombining<int>;
+using CombiningStack = FlatCombining<int, std::stack<int, std::vector<int>>>;
+
+static constexpr int kTotalPairs = 200000;   // one push + one pop each
+static constexpr int kThreadCounts[] = {1, 2, 4, 8, 16, 32};
+
+// A thread's pop always follows its own push, so there is always something to take
+static void take(CombiningQueue& queue) { queue.try_pop(); }
+static void take(CombiningStack& stack) { stack.try_pop(); }
+static void take(ThreadSafeQueue<int>& queue) { int item; queue.dequeue(item); }
+static void take(ThreadSafeStack<int>& stack) { stack.pop(); }
+
+static void put(ThreadSafeQueue<int>& queue, int item) { queue.enqueue(item); }
+template<typename Container>
+static void put(Container& container, int item) { container.push(item); }
+
+// Millions of operations (push or pop) per second
+template<typename Container>
+static double run(int threads) {
+    Container container;
+    int per_thread = kTotalPairs / threads;
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < per_thread; ++i) {
+                put(container, i);
+                take(container);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return 2.0 * per_thread * threads / seconds / 1e6;
+}
+
+int main() {
+    std::printf("threads   FC queue   ThreadSafeQueue   FC stack   ThreadSafeStack   (Mops/s)\n");
+    for (int threads : kThreadCounts) {
+        std::printf("%7d   %8.2f   %15.2f   %8.2f   %15.2f\n", threads,
+                    run<CombiningQueue>(threads), run<ThreadSafeQueue<int>>(threads),
+                    run<CombiningStack>(threads), run<ThreadSafeStack<int>>(threads));
+    }
+    return 0;
+}
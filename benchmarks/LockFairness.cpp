@@ -0,0 +1,82 @@
+//Scalability and fairness of SpinLock, TTASSpinLock, TicketLock and MCSLock, up to 64 threads.
+//Each run lasts a fixed time; every thread takes the lock as often as it can and records how long
+//each acquisition waited. Reports total throughput, the spread of acquisitions across threads
+//(min/max per thread) and the longest single wait - the starvation the fair locks are meant to remove.
+//Build: g++ -std=c++20 -O2 -pthread LockFairness.cpp -o lock_fairness
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../SpinLock.cpp"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr auto kRunTime = std::chrono::milliseconds(100);
+static constexpr int kThreadCounts[] = {1, 4, 16, 64};
+
+struct alignas(64) ThreadStats {
+    long long acquisitions = 0;
+    long long max_wait_ns = 0;
+};
+
+template<typename Lock>
+static void run(const char* name, int threads) {
+    Lock lock;
+    long long counter = 0;
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+    std::vector<ThreadStats> stats(threads);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            ThreadStats& mine = stats[t];
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto start = Clock::now();
+                lock.lock();
+                auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+                ++counter;
+                lock.unlock();
+                ++mine.acquisitions;
+                mine.max_wait_ns = std::max<long long>(mine.max_wait_ns, waited);
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(kRunTime);
+    stop.store(true, std::memory_order_relaxed);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    long long total = 0, fewest = stats[0].acquisitions, most = 0, max_wait = 0;
+    for (const ThreadStats& s : stats) {
+        total += s.acquisitions;
+        fewest = std::min(fewest, s.acquisitions);
+        most = std::max(most, s.acquisitions);
+        max_wait = std::max(max_wait, s.max_wait_ns);
+    }
+    if (total != counter) {
+        std::fprintf(stderr, "%s: lost updates\n", name);
+    }
+    std::printf("%-6s %7d %10.2f %12lld %12lld %12.3f\n", name, threads,
+                total / seconds / 1e6, fewest, most, max_wait / 1e6);
+}
+
+int main() {
+    std::printf("lock   threads     Mops/s   min/thread   max/thread  max wait ms\n");
+    for (int threads : kThreadCounts) {
+        run<SpinLock>("TAS", threads);
+        run<TTASSpinLock>("TTAS", threads);
+        run<TicketLock>("Ticket", threads);
+        run<MCSLock>("MCS", threads);
+    }
+    return 0;
+}
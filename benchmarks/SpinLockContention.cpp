@@ -0,0 +1,52 @@
+//Contention benchmark: SpinLock (test-and-set) vs TTASSpinLock vs std::mutex.
+//Every thread increments one shared counter under the lock; the total number of increments
+//is fixed, so the numbers show how throughput changes as threads are added.
+//Build: g++ -std=c++20 -O2 -pthread SpinLockContention.cpp -o spinlock_contention
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../SpinLock.cpp"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kTotalOps = 400000;
+static constexpr int kThreadCounts[] = {1, 2, 4, 8, 16};
+
+// Millions of lock/unlock pairs per second
+template<typename Lock>
+static double run(int threads) {
+    Lock lock;
+    long long counter = 0;
+    int per_thread = kTotalOps / threads;
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < per_thread; ++i) {
+                std::lock_guard<Lock> guard(lock);
+                ++counter;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (counter != static_cast<long long>(per_thread) * threads) {
+        std::fprintf(stderr, "lost updates: %lld\n", counter);
+    }
+    return counter / seconds / 1e6;
+}
+
+int main() {
+    std::printf("threads   TAS Mops/s   TTAS Mops/s   std::mutex Mops/s\n");
+    for (int threads : kThreadCounts) {
+        std::printf("%7d   %10.2f   %11.2f   %17.2f\n", threads,
+                    run<SpinLock>(threads), run<TTASSpinLock>(threads), run<std::mutex>(threads));
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+//Enqueue latency of ThreadSafeQueue with and without a consumer parked in wait_dequeue.
+//Compares the current enqueue (notify only when a consumer is waiting, after unlocking) with the
+//previous one (notify_one on every enqueue, under the lock). Reports p50/p99/max per enqueue.
+//Build: g++ -std=c++20 -O2 -pthread ThreadSafeQueueEnqueueLatency.cpp -o enqueue_latency
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "../ThreadSafeQueue"
+
+// ThreadSafeQueue's enqueue path as it was before the waiter counter
+template<typename T>
+class NotifyAlwaysQueue {
+private:
+    std::queue<T> queue_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+
+public:
+    void enqueue(T item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(std::move(item));
+        condition_.notify_one();
+    }
+
+    T wait_dequeue() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !queue_.empty(); });
+        T item = std::move(queue_.front());
+        queue_.pop();
+        return item;
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kSamples = 20000;
+static constexpr int kWaiterSamples = 2000;   // each one waits for the consumer to park again
+
+struct Summary {
+    long long p50, p99, max;
+};
+
+static Summary summarize(std::vector<long long>& ns) {
+    std::sort(ns.begin(), ns.end());
+    return {ns[ns.size() / 2], ns[ns.size() * 99 / 100], ns.back()};
+}
+
+// Nobody waiting: the producer enqueues a batch, then drains it itself
+template<typename Queue>
+static Summary without_waiters() {
+    Queue queue;
+    std::vector<long long> ns;
+    ns.reserve(kSamples);
+    for (int i = 0; i < kSamples; ++i) {
+        auto start = Clock::now();
+        queue.enqueue(i);
+        ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        if (i % 64 == 63) {
+            for (int j = 0; j < 64; ++j) queue.wait_dequeue();
+        }
+    }
+    return summarize(ns);
+}
+
+// A consumer is parked in wait_dequeue before every enqueue
+template<typename Queue>
+static Summary with_waiter() {
+    Queue queue;
+    std::atomic<int> consumed{0};
+    std::thread consumer([&] {
+        for (int i = 0; i < kWaiterSamples; ++i) {
+            queue.wait_dequeue();
+            consumed.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    std::vector<long long> ns;
+    ns.reserve(kWaiterSamples);
+    for (int i = 0; i < kWaiterSamples; ++i) {
+        while (consumed.load(std::memory_order_acquire) != i) std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));  // let the consumer block again
+        auto start = Clock::now();
+        queue.enqueue(i);
+        ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    consumer.join();
+    return summarize(ns);
+}
+
+static void report(const char* name, Summary s) {
+    std::printf("%-32s p50 %7lld ns   p99 %7lld ns   max %9lld ns\n", name, s.p50, s.p99, s.max);
+}
+
+int main() {
+    report("ThreadSafeQueue, no waiters", without_waiters<ThreadSafeQueue<int>>());
+    report("notify-always, no waiters", without_waiters<NotifyAlwaysQueue<int>>());
+    report("ThreadSafeQueue, waiter", with_waiter<ThreadSafeQueue<int>>());
+    report("notify-always, waiter", with_waiter<NotifyAlwaysQueue<int>>());
+    return 0;
+}